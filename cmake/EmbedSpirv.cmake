@@ -0,0 +1,39 @@
+# Converts a SPIR-V binary into a C++ header with the words as a uint32_t array.
+# Usage: cmake -DINPUT=<file.spv> -DOUTPUT=<file.h> -DNAME=<identifier> -P EmbedSpirv.cmake
+
+file (READ ${INPUT} SPIRV_HEX HEX)
+string (LENGTH "${SPIRV_HEX}" SPIRV_HEX_LENGTH)
+math (EXPR SPIRV_REMAINDER "${SPIRV_HEX_LENGTH} % 8")
+if (SPIRV_HEX_LENGTH EQUAL 0 OR NOT SPIRV_REMAINDER EQUAL 0)
+  message (FATAL_ERROR "${INPUT} is not a valid SPIR-V binary")
+endif ()
+
+# 8 words per line, bytes are stored little endian
+set (SPIRV_LINES "")
+set (SPIRV_OFFSET 0)
+while (SPIRV_OFFSET LESS SPIRV_HEX_LENGTH)
+  string (SUBSTRING "${SPIRV_HEX}" ${SPIRV_OFFSET} 64 SPIRV_LINE)
+  string (REGEX REPLACE "([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])"
+          "0x\\4\\3\\2\\1u, " SPIRV_LINE "${SPIRV_LINE}")
+  string (STRIP "${SPIRV_LINE}" SPIRV_LINE)
+  string (APPEND SPIRV_LINES "    ${SPIRV_LINE}\n")
+  math (EXPR SPIRV_OFFSET "${SPIRV_OFFSET} + 64")
+endwhile ()
+
+get_filename_component (SPIRV_SOURCE ${INPUT} NAME)
+file (WRITE ${OUTPUT}
+"// Generated from ${SPIRV_SOURCE} by EmbedSpirv.cmake, do not edit.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace shaders {
+
+const uint32_t ${NAME}[] = {
+${SPIRV_LINES}};
+
+const size_t ${NAME}_size = sizeof(${NAME});
+
+}
+")
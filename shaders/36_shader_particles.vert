@@ -0,0 +1,38 @@
+#version 450
+
+struct Particle {
+    vec2 position;
+    vec2 velocity;
+    vec3 color;
+    float life;
+};
+
+layout (binding = 0) uniform ParameterUBO {
+    float deltaTime;
+    uint capacity;
+    uint emitCount;
+    uint parity;
+    uint maxGroupCount;
+    uint seed;
+} ubo;
+
+layout (std430, binding = 1) readonly buffer ParticleSSBO {
+    Particle particles[ ];
+};
+
+layout (std430, binding = 2) readonly buffer AliveListSSBO {
+    uint aliveList[ ];
+};
+
+layout(location = 0) out vec4 fragColor;
+
+void main() {
+    // 间接绘制的顶点数等于模拟后存活列表的长度
+    uint index = aliveList[(1u - ubo.parity) * ubo.capacity + gl_VertexIndex];
+    Particle particle = particles[index];
+
+    gl_PointSize = 14.0;
+    gl_Position = vec4(particle.position, 1.0, 1.0);
+    // 最后一秒逐渐淡出
+    fragColor = vec4(particle.color, clamp(particle.life / 1000.0, 0.0, 1.0));
+}
@@ -0,0 +1,14 @@
+#version 450
+
+// 两个顶点缓冲：位置(R32G32_SFLOAT)与打包的颜色(R8G8B8A8_UNORM)
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec4 inColor;
+
+layout(location = 0) out vec3 fragColor;
+
+void main() {
+
+    gl_PointSize = 14.0;
+    gl_Position = vec4(inPosition.xy, 1.0, 1.0);
+    fragColor = inColor.rgb;
+}
@@ -0,0 +1,21 @@
+#version 450
+
+// true: 透明度从中心向边缘递减，false: 实心圆
+layout(constant_id = 1) const bool SOFT_EDGES = true;
+
+layout(location = 0) in vec3 fragColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+
+    vec2 coord = gl_PointCoord - vec2(0.5);
+    if (SOFT_EDGES) {
+        outColor = vec4(fragColor, 0.5 - length(coord));
+    } else {
+        if (length(coord) > 0.5) {
+            discard;
+        }
+        outColor = vec4(fragColor, 0.5);
+    }
+}
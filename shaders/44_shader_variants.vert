@@ -0,0 +1,16 @@
+#version 450
+
+// 点的大小由特化常量决定，每个取值对应一个管线变体
+layout(constant_id = 0) const float POINT_SIZE = 14.0;
+
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec4 inColor;
+
+layout(location = 0) out vec3 fragColor;
+
+void main() {
+
+    gl_PointSize = POINT_SIZE;
+    gl_Position = vec4(inPosition.xy, 1.0, 1.0);
+    fragColor = inColor.rgb;
+}
@@ -0,0 +1,6 @@
+// 计算着色器中的粒子数据布局，与C++中的Particle一致
+struct Particle {
+	vec2 position;
+	vec2 velocity;
+    vec4 color;
+};
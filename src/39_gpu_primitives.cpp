@@ -0,0 +1,1105 @@
+/*
+    * GPU并行原语 GPU Parallel Primitives
+    * 之前计算管线只有一个写死的粒子模拟着色器。
+    * 这里把常用的并行原语封装为GpuPrimitives类，直接作用于VkBuffer(元素为uint32_t)，
+    * 录制到调用者的命令缓冲中，可以用于剔除、粒子排序、流压缩等：
+    *   reduce:        求和
+    *   exclusiveScan: 排他前缀和(线程组内扫描 + 线程组总和递归扫描 + 加回偏移)
+    *   sortPairs:     键值对基数排序(稳定，每趟4位，count -> scan -> scatter)
+    *   compact:       流压缩(flags的前缀和作为写入位置)
+    * 设备支持子组运算(Vulkan 1.1，计算阶段支持arithmetic与ballot，子组大小 >= 4)时使用子组版本的着色器，
+    * 否则使用共享内存版本。
+    * 这一章不创建窗口和交换链，运行后对每种实现做正确性检查(与CPU结果比较)和吞吐量测试：
+    *   --count N        吞吐量测试的元素数量(默认4M)
+    *   --iterations N   吞吐量测试的重复次数(默认20)
+    *   --no-subgroups   只测试共享内存版本
+    * 有检查失败时返回EXIT_FAILURE，可以在lavapipe等无显示设备的环境中运行。
+    *
+    * add:
+    *   GpuPrimitives
+    *   PrimitivesApplication
+    *   checkSubgroupSupport()
+    *   runSelfTests()
+    *   runBenchmarks()
+*/
+
+#include <vulkan/vulkan.h>
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <limits>
+#include <array>
+#include <optional>
+#include <random>
+#include <string>
+
+const uint32_t WORKGROUP_SIZE = 256;
+const uint32_t RADIX_BITS = 4;
+const uint32_t RADIX_BUCKETS = 1 << RADIX_BITS;
+const uint32_t MAX_DESCRIPTOR_SETS = 4096;
+
+const std::vector<const char*> validationLayers = {
+    "VK_LAYER_KHRONOS_validation"
+};
+
+#ifdef NDEBUG
+const bool enableValidationLayers = false;
+#else
+const bool enableValidationLayers = true;
+#endif
+
+VkResult CreateDebugUtilsMessengerEXT(VkInstance instance, const VkDebugUtilsMessengerCreateInfoEXT* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkDebugUtilsMessengerEXT* pDebugMessenger) {
+    auto func = (PFN_vkCreateDebugUtilsMessengerEXT) vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT");
+    if (func != nullptr) {
+        return func(instance, pCreateInfo, pAllocator, pDebugMessenger);
+    } else {
+        return VK_ERROR_EXTENSION_NOT_PRESENT;
+    }
+}
+
+void DestroyDebugUtilsMessengerEXT(VkInstance instance, VkDebugUtilsMessengerEXT debugMessenger, const VkAllocationCallbacks* pAllocator) {
+    auto func = (PFN_vkDestroyDebugUtilsMessengerEXT) vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT");
+    if (func != nullptr) {
+        func(instance, debugMessenger, pAllocator);
+    }
+}
+
+static std::vector<char> readFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::ate | std::ios::binary);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("failed to open file!");
+    }
+
+    size_t fileSize = (size_t) file.tellg();
+    std::vector<char> buffer(fileSize);
+
+    file.seekg(0);
+    file.read(buffer.data(), fileSize);
+
+    file.close();
+
+    return buffer;
+}
+
+// 所有着色器共用的push constant
+struct PrimitiveParams {
+    uint32_t count;
+    uint32_t shift;
+};
+
+// 并行原语：所有操作都录制到调用者的命令缓冲中，操作之间已经插入屏障，可以连续调用。
+// 临时缓冲与描述集在reset()之前一直有效，调用者需要在命令缓冲执行完成后再调用reset()。
+class GpuPrimitives {
+public:
+    void init(VkPhysicalDevice physicalDevice, VkDevice device, bool useSubgroups) {
+        this->physicalDevice = physicalDevice;
+        this->device = device;
+        subgroups = useSubgroups;
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        maxGroupCount = properties.limits.maxComputeWorkGroupCount[0];
+
+        createDescriptorSetLayout();
+        createPipelines();
+        createDescriptorPool();
+    }
+
+    void cleanup() {
+        reset();
+        for (auto& scratch : scratchBuffers) {
+            vkDestroyBuffer(device, scratch.buffer, nullptr);
+            vkFreeMemory(device, scratch.memory, nullptr);
+        }
+        scratchBuffers.clear();
+
+        vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+
+        vkDestroyPipeline(device, reducePipeline, nullptr);
+        vkDestroyPipeline(device, scanPipeline, nullptr);
+        vkDestroyPipeline(device, scanAddPipeline, nullptr);
+        vkDestroyPipeline(device, radixCountPipeline, nullptr);
+        vkDestroyPipeline(device, radixScatterPipeline, nullptr);
+        vkDestroyPipeline(device, compactPipeline, nullptr);
+        vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+        vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+    }
+
+    bool usesSubgroups() const {
+        return subgroups;
+    }
+
+    // 上一次reset()之后分配的描述集数量，不能超过MAX_DESCRIPTOR_SETS
+    uint32_t getAllocatedSetCount() const {
+        return allocatedSetCount;
+    }
+
+    // 释放上一次录制使用的描述集和被替换的临时缓冲
+    void reset() {
+        vkResetDescriptorPool(device, descriptorPool, 0);
+        allocatedSetCount = 0;
+        for (auto& scratch : retiredBuffers) {
+            vkDestroyBuffer(device, scratch.buffer, nullptr);
+            vkFreeMemory(device, scratch.memory, nullptr);
+        }
+        retiredBuffers.clear();
+    }
+
+    // result[0] = sum(input[0, count))
+    void reduce(VkCommandBuffer commandBuffer, VkBuffer input, uint32_t count, VkBuffer result) {
+        uint32_t groupCount = getGroupCount(count);
+        if (groupCount == 1) {
+            dispatch(commandBuffer, reducePipeline, { input, result }, { count, 0 }, 1);
+            barrier(commandBuffer);
+            return;
+        }
+
+        // 每个线程组的部分和再归约一次，直到只剩一个线程组
+        VkBuffer partialSums = pushScratch(sizeof(uint32_t) * groupCount);
+        dispatch(commandBuffer, reducePipeline, { input, partialSums }, { count, 0 }, groupCount);
+        barrier(commandBuffer);
+        reduce(commandBuffer, partialSums, groupCount, result);
+        popScratch(1);
+    }
+
+    // output[i] = sum(input[0, i))，input与output可以是同一个缓冲
+    void exclusiveScan(VkCommandBuffer commandBuffer, VkBuffer input, VkBuffer output, uint32_t count) {
+        uint32_t groupCount = getGroupCount(count);
+        VkBuffer blockSums = pushScratch(sizeof(uint32_t) * groupCount);
+
+        dispatch(commandBuffer, scanPipeline, { input, output, blockSums }, { count, 0 }, groupCount);
+        barrier(commandBuffer);
+
+        if (groupCount > 1) {
+            exclusiveScan(commandBuffer, blockSums, blockSums, groupCount);
+            dispatch(commandBuffer, scanAddPipeline, { blockSums, output }, { count, 0 }, groupCount);
+            barrier(commandBuffer);
+        }
+
+        popScratch(1);
+    }
+
+    // 按键的低keyBits位对键值对做稳定排序，结果写回keys与values
+    void sortPairs(VkCommandBuffer commandBuffer, VkBuffer keys, VkBuffer values, uint32_t count, uint32_t keyBits = 32) {
+        uint32_t groupCount = getGroupCount(count);
+        uint32_t passCount = (keyBits + RADIX_BITS - 1) / RADIX_BITS;
+
+        VkBuffer scratchKeys = pushScratch(sizeof(uint32_t) * count);
+        VkBuffer scratchValues = pushScratch(sizeof(uint32_t) * count);
+        VkBuffer histogram = pushScratch(sizeof(uint32_t) * RADIX_BUCKETS * groupCount);
+
+        std::array<VkBuffer, 2> keyBuffers = { keys, scratchKeys };
+        std::array<VkBuffer, 2> valueBuffers = { values, scratchValues };
+
+        for (uint32_t pass = 0; pass < passCount; pass++) {
+            VkBuffer keysIn = keyBuffers[pass % 2];
+            VkBuffer valuesIn = valueBuffers[pass % 2];
+            VkBuffer keysOut = keyBuffers[(pass + 1) % 2];
+            VkBuffer valuesOut = valueBuffers[(pass + 1) % 2];
+            PrimitiveParams params = { count, pass * RADIX_BITS };
+
+            dispatch(commandBuffer, radixCountPipeline, { keysIn, histogram }, params, groupCount);
+            barrier(commandBuffer);
+
+            // 桶优先的直方图扫描后即为每个线程组每个桶的写入起点
+            exclusiveScan(commandBuffer, histogram, histogram, RADIX_BUCKETS * groupCount);
+
+            dispatch(commandBuffer, radixScatterPipeline, { keysIn, valuesIn, keysOut, valuesOut, histogram }, params, groupCount);
+            barrier(commandBuffer);
+        }
+
+        // 奇数趟时结果在临时缓冲中
+        if (passCount % 2 == 1) {
+            VkBufferCopy copyRegion{};
+            copyRegion.size = sizeof(uint32_t) * count;
+            vkCmdCopyBuffer(commandBuffer, scratchKeys, keys, 1, &copyRegion);
+            vkCmdCopyBuffer(commandBuffer, scratchValues, values, 1, &copyRegion);
+            barrier(commandBuffer);
+        }
+
+        popScratch(3);
+    }
+
+    // flags为0或1，flags为1的values按原顺序写入output，数量写入outputCount[0]
+    void compact(VkCommandBuffer commandBuffer, VkBuffer values, VkBuffer flags, uint32_t count, VkBuffer output, VkBuffer outputCount) {
+        uint32_t groupCount = getGroupCount(count);
+        VkBuffer offsets = pushScratch(sizeof(uint32_t) * count);
+
+        exclusiveScan(commandBuffer, flags, offsets, count);
+
+        dispatch(commandBuffer, compactPipeline, { values, flags, offsets, output, outputCount }, { count, 0 }, groupCount);
+        barrier(commandBuffer);
+
+        popScratch(1);
+    }
+
+private:
+    struct ScratchBuffer {
+        VkBuffer buffer;
+        VkDeviceMemory memory;
+        VkDeviceSize size;
+    };
+
+    VkPhysicalDevice physicalDevice;
+    VkDevice device;
+    bool subgroups = false;
+    uint32_t maxGroupCount = 65535;
+
+    VkDescriptorSetLayout descriptorSetLayout;
+    VkPipelineLayout pipelineLayout;
+    VkPipeline reducePipeline;
+    VkPipeline scanPipeline;
+    VkPipeline scanAddPipeline;
+    VkPipeline radixCountPipeline;
+    VkPipeline radixScatterPipeline;
+    VkPipeline compactPipeline;
+
+    VkDescriptorPool descriptorPool;
+    uint32_t allocatedSetCount = 0;
+
+    // 临时缓冲按调用深度复用：同一深度的操作之间有屏障，不会同时使用
+    std::vector<ScratchBuffer> scratchBuffers;
+    std::vector<ScratchBuffer> retiredBuffers;// 已被录制的命令引用，reset()时才能销毁
+    size_t scratchDepth = 0;
+
+    uint32_t getGroupCount(uint32_t count) {
+        if (count == 0) {
+            throw std::runtime_error("primitive called with zero elements!");
+        }
+        uint32_t groupCount = (count + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE;
+        if (groupCount > maxGroupCount) {
+            throw std::runtime_error("too many elements for a single dispatch!");
+        }
+        return groupCount;
+    }
+
+    // 所有着色器使用同一个布局：最多5个存储缓冲，着色器只声明自己用到的绑定
+    void createDescriptorSetLayout() {
+        std::array<VkDescriptorSetLayoutBinding, 5> layoutBindings{};
+        for (uint32_t i = 0; i < layoutBindings.size(); i++) {
+            layoutBindings[i].binding = i;
+            layoutBindings[i].descriptorCount = 1;
+            layoutBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            layoutBindings[i].pImmutableSamplers = nullptr;
+            layoutBindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(layoutBindings.size());
+        layoutInfo.pBindings = layoutBindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create primitives descriptor set layout!");
+        }
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(PrimitiveParams);
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create primitives pipeline layout!");
+        }
+    }
+
+    void createPipelines() {
+        std::string variant = subgroups ? "_subgroup" : "";
+        reducePipeline = createKernelPipeline("../shaders/39_kernel_reduce" + variant + ".spv");
+        scanPipeline = createKernelPipeline("../shaders/39_kernel_scan" + variant + ".spv");
+        scanAddPipeline = createKernelPipeline("../shaders/39_kernel_scan_add.spv");
+        radixCountPipeline = createKernelPipeline("../shaders/39_kernel_radix_count.spv");
+        radixScatterPipeline = createKernelPipeline("../shaders/39_kernel_radix_scatter" + variant + ".spv");
+        compactPipeline = createKernelPipeline("../shaders/39_kernel_compact.spv");
+    }
+
+    VkPipeline createKernelPipeline(const std::string& filename) {
+        auto computeShaderCode = readFile(filename);
+
+        VkShaderModuleCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        createInfo.codeSize = computeShaderCode.size();
+        createInfo.pCode = reinterpret_cast<const uint32_t*>(computeShaderCode.data());
+
+        VkShaderModule computeShaderModule;
+        if (vkCreateShaderModule(device, &createInfo, nullptr, &computeShaderModule) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create shader module!");
+        }
+
+        VkPipelineShaderStageCreateInfo computeShaderStageInfo{};
+        computeShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        computeShaderStageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        computeShaderStageInfo.module = computeShaderModule;
+        computeShaderStageInfo.pName = "main";
+
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.layout = pipelineLayout;
+        pipelineInfo.stage = computeShaderStageInfo;
+
+        VkPipeline pipeline;
+        if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create compute pipeline!");
+        }
+
+        vkDestroyShaderModule(device, computeShaderModule, nullptr);
+
+        return pipeline;
+    }
+
+    // 每次调度分配一个描述集，reset()时整体释放
+    void createDescriptorPool() {
+        VkDescriptorPoolSize poolSize{};
+        poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        poolSize.descriptorCount = MAX_DESCRIPTOR_SETS * 5;
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+        poolInfo.maxSets = MAX_DESCRIPTOR_SETS;
+
+        if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create primitives descriptor pool!");
+        }
+    }
+
+    void dispatch(VkCommandBuffer commandBuffer, VkPipeline pipeline, std::initializer_list<VkBuffer> buffers, PrimitiveParams params, uint32_t groupCount) {
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &descriptorSetLayout;
+
+        VkDescriptorSet descriptorSet;
+        if (vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate primitives descriptor set, call reset() more often!");
+        }
+        allocatedSetCount++;
+
+        std::vector<VkDescriptorBufferInfo> bufferInfos;
+        for (VkBuffer buffer : buffers) {
+            bufferInfos.push_back({ buffer, 0, VK_WHOLE_SIZE });
+        }
+
+        std::vector<VkWriteDescriptorSet> descriptorWrites(bufferInfos.size());
+        for (uint32_t binding = 0; binding < descriptorWrites.size(); binding++) {
+            descriptorWrites[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[binding].dstSet = descriptorSet;
+            descriptorWrites[binding].dstBinding = binding;
+            descriptorWrites[binding].dstArrayElement = 0;
+            descriptorWrites[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            descriptorWrites[binding].descriptorCount = 1;
+            descriptorWrites[binding].pBufferInfo = &bufferInfos[binding];
+        }
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PrimitiveParams), &params);
+        vkCmdDispatch(commandBuffer, groupCount, 1, 1);
+    }
+
+    // 调度与复制的写入对之后的调度与复制可见
+    void barrier(VkCommandBuffer commandBuffer) {
+        VkMemoryBarrier memoryBarrier{};
+        memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        VkPipelineStageFlags stages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+        vkCmdPipelineBarrier(commandBuffer, stages, stages, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    VkBuffer pushScratch(VkDeviceSize size) {
+        if (scratchDepth == scratchBuffers.size()) {
+            scratchBuffers.push_back(createScratchBuffer(size));
+        } else if (scratchBuffers[scratchDepth].size < size) {
+            retiredBuffers.push_back(scratchBuffers[scratchDepth]);
+            scratchBuffers[scratchDepth] = createScratchBuffer(size);
+        }
+        return scratchBuffers[scratchDepth++].buffer;
+    }
+
+    void popScratch(size_t count) {
+        scratchDepth -= count;
+    }
+
+    ScratchBuffer createScratchBuffer(VkDeviceSize size) {
+        ScratchBuffer scratch{};
+        scratch.size = size;
+
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = size;
+        bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (vkCreateBuffer(device, &bufferInfo, nullptr, &scratch.buffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create scratch buffer!");
+        }
+
+        VkMemoryRequirements memRequirements;
+        vkGetBufferMemoryRequirements(device, scratch.buffer, &memRequirements);
+
+        VkPhysicalDeviceMemoryProperties memProperties;
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+        std::optional<uint32_t> memoryTypeIndex;
+        for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+            if ((memRequirements.memoryTypeBits & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)) {
+                memoryTypeIndex = i;
+                break;
+            }
+        }
+        if (!memoryTypeIndex.has_value()) {
+            throw std::runtime_error("failed to find suitable memory type!");
+        }
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memRequirements.size;
+        allocInfo.memoryTypeIndex = memoryTypeIndex.value();
+
+        if (vkAllocateMemory(device, &allocInfo, nullptr, &scratch.memory) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate scratch buffer memory!");
+        }
+
+        vkBindBufferMemory(device, scratch.buffer, scratch.memory, 0);
+
+        return scratch;
+    }
+};
+
+class PrimitivesApplication {
+public:
+    void parseArguments(int argc, char* argv[]) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--count" && i + 1 < argc) {
+                long long count = std::atoll(argv[++i]);
+                if (count <= 0 || count > std::numeric_limits<uint32_t>::max() / 2) {
+                    throw std::runtime_error("invalid element count: " + std::string(argv[i]));
+                }
+                benchmarkCount = static_cast<uint32_t>(count);
+            } else if (arg == "--iterations" && i + 1 < argc) {
+                int iterations = std::atoi(argv[++i]);
+                if (iterations <= 0) {
+                    throw std::runtime_error("invalid iteration count: " + std::string(argv[i]));
+                }
+                benchmarkIterations = static_cast<uint32_t>(iterations);
+            } else if (arg == "--no-subgroups") {
+                allowSubgroups = false;
+            } else {
+                throw std::runtime_error("unknown argument: " + arg);
+            }
+        }
+    }
+
+    // 返回是否所有检查都通过
+    bool run() {
+        initVulkan();
+
+        std::vector<bool> variants = { false };
+        if (allowSubgroups && subgroupsSupported) {
+            variants.push_back(true);
+        }
+
+        bool passed = true;
+        for (bool useSubgroups : variants) {
+            GpuPrimitives primitives;
+            primitives.init(physicalDevice, device, useSubgroups);
+            std::cout << (useSubgroups ? "[subgroup]" : "[shared memory]") << std::endl;
+
+            passed = runSelfTests(primitives) && passed;
+            runBenchmarks(primitives);
+
+            primitives.cleanup();
+        }
+
+        cleanup();
+
+        std::cout << (passed ? "all checks passed" : "some checks FAILED") << std::endl;
+        return passed;
+    }
+
+private:
+    VkInstance instance;
+    VkDebugUtilsMessengerEXT debugMessenger;
+    VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+    VkDevice device;
+    uint32_t computeFamily;
+    VkQueue computeQueue;
+    VkCommandPool commandPool;
+
+    bool allowSubgroups = true;
+    bool subgroupsSupported = false;
+    uint32_t benchmarkCount = 1 << 22;
+    uint32_t benchmarkIterations = 20;
+
+    std::default_random_engine rndEngine{ 42 };
+
+    void initVulkan() {
+        createInstance();
+        setupDebugMessenger();
+        pickPhysicalDevice();
+        createLogicalDevice();
+        createCommandPool();
+    }
+
+    void cleanup() {
+        vkDestroyCommandPool(device, commandPool, nullptr);
+
+        vkDestroyDevice(device, nullptr);
+
+        if (enableValidationLayers) {
+            DestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
+        }
+
+        vkDestroyInstance(instance, nullptr);
+    }
+
+    // 不需要窗口，也就不需要表面与交换链扩展
+    void createInstance() {
+        if (enableValidationLayers && !checkValidationLayerSupport()) {
+            throw std::runtime_error("validation layers requested, but not available!");
+        }
+
+        VkApplicationInfo appInfo{};
+        appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        appInfo.pApplicationName = "GPU Primitives";
+        appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
+        appInfo.pEngineName = "No Engine";
+        appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
+        appInfo.apiVersion = VK_API_VERSION_1_1;// 子组属性需要Vulkan 1.1
+
+        VkInstanceCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        createInfo.pApplicationInfo = &appInfo;
+
+        std::vector<const char*> extensions;
+        if (enableValidationLayers) {
+            extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+        }
+        createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+        createInfo.ppEnabledExtensionNames = extensions.data();
+
+        VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo{};
+        if (enableValidationLayers) {
+            createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
+            createInfo.ppEnabledLayerNames = validationLayers.data();
+
+            populateDebugMessengerCreateInfo(debugCreateInfo);
+            createInfo.pNext = (VkDebugUtilsMessengerCreateInfoEXT*) &debugCreateInfo;
+        } else {
+            createInfo.enabledLayerCount = 0;
+
+            createInfo.pNext = nullptr;
+        }
+
+        if (vkCreateInstance(&createInfo, nullptr, &instance) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create instance!");
+        }
+    }
+
+    void populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo) {
+        createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+        createInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+        createInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+        createInfo.pfnUserCallback = debugCallback;
+    }
+
+    void setupDebugMessenger() {
+        if (!enableValidationLayers) return;
+
+        VkDebugUtilsMessengerCreateInfoEXT createInfo;
+        populateDebugMessengerCreateInfo(createInfo);
+
+        if (CreateDebugUtilsMessengerEXT(instance, &createInfo, nullptr, &debugMessenger) != VK_SUCCESS) {
+            throw std::runtime_error("failed to set up debug messenger!");
+        }
+    }
+
+    // 只需要一个支持计算的队列族
+    void pickPhysicalDevice() {
+        uint32_t deviceCount = 0;
+        vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
+
+        if (deviceCount == 0) {
+            throw std::runtime_error("failed to find GPUs with Vulkan support!");
+        }
+
+        std::vector<VkPhysicalDevice> devices(deviceCount);
+        vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
+
+        for (const auto& device : devices) {
+            std::optional<uint32_t> family = findComputeFamily(device);
+            if (family.has_value()) {
+                physicalDevice = device;
+                computeFamily = family.value();
+                break;
+            }
+        }
+
+        if (physicalDevice == VK_NULL_HANDLE) {
+            throw std::runtime_error("failed to find a suitable GPU!");
+        }
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        subgroupsSupported = checkSubgroupSupport(properties);
+        std::cout << "device: " << properties.deviceName
+                  << ", subgroups: " << (subgroupsSupported ? "supported" : "not supported") << std::endl;
+    }
+
+    std::optional<uint32_t> findComputeFamily(VkPhysicalDevice device) {
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
+
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
+
+        for (uint32_t i = 0; i < queueFamilyCount; i++) {
+            if (queueFamilies[i].queueFlags & VK_QUEUE_COMPUTE_BIT) {
+                return i;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    // 子组版本的着色器需要SPIR-V 1.3(Vulkan 1.1)，计算阶段支持arithmetic与ballot，
+    // 并且子组大小至少为4(共享内存中按最多64个子组分配)
+    bool checkSubgroupSupport(const VkPhysicalDeviceProperties& properties) {
+        if (properties.apiVersion < VK_API_VERSION_1_1) {
+            return false;
+        }
+
+        VkPhysicalDeviceSubgroupProperties subgroupProperties{};
+        subgroupProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
+
+        VkPhysicalDeviceProperties2 properties2{};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties2.pNext = &subgroupProperties;
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+
+        VkSubgroupFeatureFlags requiredOperations = VK_SUBGROUP_FEATURE_BASIC_BIT | VK_SUBGROUP_FEATURE_ARITHMETIC_BIT | VK_SUBGROUP_FEATURE_BALLOT_BIT;
+        return (subgroupProperties.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT) &&
+               (subgroupProperties.supportedOperations & requiredOperations) == requiredOperations &&
+               subgroupProperties.subgroupSize >= 4;
+    }
+
+    void createLogicalDevice() {
+        float queuePriority = 1.0f;
+        VkDeviceQueueCreateInfo queueCreateInfo{};
+        queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queueCreateInfo.queueFamilyIndex = computeFamily;
+        queueCreateInfo.queueCount = 1;
+        queueCreateInfo.pQueuePriorities = &queuePriority;
+
+        VkPhysicalDeviceFeatures deviceFeatures{};
+
+        VkDeviceCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+
+        createInfo.queueCreateInfoCount = 1;
+        createInfo.pQueueCreateInfos = &queueCreateInfo;
+
+        createInfo.pEnabledFeatures = &deviceFeatures;
+
+        createInfo.enabledExtensionCount = 0;
+
+        if (enableValidationLayers) {
+            createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
+            createInfo.ppEnabledLayerNames = validationLayers.data();
+        } else {
+            createInfo.enabledLayerCount = 0;
+        }
+
+        if (vkCreateDevice(physicalDevice, &createInfo, nullptr, &device) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create logical device!");
+        }
+
+        vkGetDeviceQueue(device, computeFamily, 0, &computeQueue);
+    }
+
+    void createCommandPool() {
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        poolInfo.queueFamilyIndex = computeFamily;
+
+        if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create compute command pool!");
+        }
+    }
+
+    void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = size;
+        bufferInfo.usage = usage;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create buffer!");
+        }
+
+        VkMemoryRequirements memRequirements;
+        vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memRequirements.size;
+        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+
+        if (vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate buffer memory!");
+        }
+
+        vkBindBufferMemory(device, buffer, bufferMemory, 0);
+    }
+
+    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
+        VkPhysicalDeviceMemoryProperties memProperties;
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+        for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+            if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+                return i;
+            }
+        }
+
+        throw std::runtime_error("failed to find suitable memory type!");
+    }
+
+    // 测试用的设备本地缓冲，通过暂存缓冲上传与读回
+    struct DeviceBuffer {
+        VkBuffer buffer;
+        VkDeviceMemory memory;
+    };
+
+    DeviceBuffer createDeviceBuffer(uint32_t count) {
+        DeviceBuffer deviceBuffer;
+        createBuffer(sizeof(uint32_t) * std::max(count, 1u),
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                    deviceBuffer.buffer,
+                    deviceBuffer.memory);
+        return deviceBuffer;
+    }
+
+    void destroyDeviceBuffer(DeviceBuffer& deviceBuffer) {
+        vkDestroyBuffer(device, deviceBuffer.buffer, nullptr);
+        vkFreeMemory(device, deviceBuffer.memory, nullptr);
+    }
+
+    // 录制并提交一次性命令缓冲，等待执行完成
+    void submitAndWait(const std::function<void(VkCommandBuffer)>& record) {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandPool = commandPool;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer commandBuffer;
+        vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer);
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        record(commandBuffer);
+        vkEndCommandBuffer(commandBuffer);
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &commandBuffer;
+
+        if (vkQueueSubmit(computeQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+            throw std::runtime_error("failed to submit compute command buffer!");
+        }
+        vkQueueWaitIdle(computeQueue);
+
+        vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+    }
+
+    void upload(DeviceBuffer& deviceBuffer, const std::vector<uint32_t>& data) {
+        VkDeviceSize bufferSize = sizeof(uint32_t) * data.size();
+
+        VkBuffer stagingBuffer;
+        VkDeviceMemory stagingBufferMemory;
+        createBuffer(bufferSize,
+                    VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                    stagingBuffer,
+                    stagingBufferMemory);
+
+        void* mapped;
+        vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &mapped);
+        memcpy(mapped, data.data(), (size_t)bufferSize);
+        vkUnmapMemory(device, stagingBufferMemory);
+
+        submitAndWait([&](VkCommandBuffer commandBuffer) {
+            VkBufferCopy copyRegion{};
+            copyRegion.size = bufferSize;
+            vkCmdCopyBuffer(commandBuffer, stagingBuffer, deviceBuffer.buffer, 1, &copyRegion);
+        });
+
+        vkDestroyBuffer(device, stagingBuffer, nullptr);
+        vkFreeMemory(device, stagingBufferMemory, nullptr);
+    }
+
+    std::vector<uint32_t> download(DeviceBuffer& deviceBuffer, uint32_t count) {
+        VkDeviceSize bufferSize = sizeof(uint32_t) * count;
+
+        VkBuffer stagingBuffer;
+        VkDeviceMemory stagingBufferMemory;
+        createBuffer(bufferSize,
+                    VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                    stagingBuffer,
+                    stagingBufferMemory);
+
+        submitAndWait([&](VkCommandBuffer commandBuffer) {
+            VkBufferCopy copyRegion{};
+            copyRegion.size = bufferSize;
+            vkCmdCopyBuffer(commandBuffer, deviceBuffer.buffer, stagingBuffer, 1, &copyRegion);
+        });
+
+        std::vector<uint32_t> data(count);
+        void* mapped;
+        vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &mapped);
+        memcpy(data.data(), mapped, (size_t)bufferSize);
+        vkUnmapMemory(device, stagingBufferMemory);
+
+        vkDestroyBuffer(device, stagingBuffer, nullptr);
+        vkFreeMemory(device, stagingBufferMemory, nullptr);
+
+        return data;
+    }
+
+    std::vector<uint32_t> randomData(uint32_t count, uint32_t maxValue) {
+        std::uniform_int_distribution<uint32_t> rndDist(0, maxValue);
+        std::vector<uint32_t> data(count);
+        for (auto& value : data) {
+            value = rndDist(rndEngine);
+        }
+        return data;
+    }
+
+    bool report(const std::string& name, uint32_t count, bool ok) {
+        std::cout << "  " << std::left << std::setw(12) << name << " n = " << std::setw(9) << count
+                  << (ok ? "ok" : "FAILED") << std::endl;
+        return ok;
+    }
+
+    // 每个原语在多个大小上与CPU结果比较，包括不是256倍数和需要多级扫描的大小
+    bool runSelfTests(GpuPrimitives& primitives) {
+        const std::array<uint32_t, 7> counts = { 1, 255, 256, 1000, 65537, 300000, 1 << 20 };
+        bool passed = true;
+
+        for (uint32_t count : counts) {
+            // 较小的值避免求和溢出，比较仍然是精确的
+            std::vector<uint32_t> input = randomData(count, 1000);
+            DeviceBuffer inputBuffer = createDeviceBuffer(count);
+            DeviceBuffer outputBuffer = createDeviceBuffer(count);
+            upload(inputBuffer, input);
+
+            // reduce
+            submitAndWait([&](VkCommandBuffer commandBuffer) {
+                primitives.reduce(commandBuffer, inputBuffer.buffer, count, outputBuffer.buffer);
+            });
+            primitives.reset();
+            uint32_t expectedSum = std::accumulate(input.begin(), input.end(), 0u);
+            passed = report("reduce", count, download(outputBuffer, 1)[0] == expectedSum) && passed;
+
+            // exclusive scan
+            submitAndWait([&](VkCommandBuffer commandBuffer) {
+                primitives.exclusiveScan(commandBuffer, inputBuffer.buffer, outputBuffer.buffer, count);
+            });
+            primitives.reset();
+            std::vector<uint32_t> expectedScan(count);
+            std::exclusive_scan(input.begin(), input.end(), expectedScan.begin(), 0u);
+            passed = report("scan", count, download(outputBuffer, count) == expectedScan) && passed;
+
+            // radix sort：值为原始下标，稳定排序的结果唯一
+            std::vector<uint32_t> keys = randomData(count, std::numeric_limits<uint32_t>::max());
+            std::vector<uint32_t> values(count);
+            std::iota(values.begin(), values.end(), 0u);
+            upload(inputBuffer, keys);
+            upload(outputBuffer, values);
+            submitAndWait([&](VkCommandBuffer commandBuffer) {
+                primitives.sortPairs(commandBuffer, inputBuffer.buffer, outputBuffer.buffer, count);
+            });
+            primitives.reset();
+            std::vector<uint32_t> expectedValues = values;
+            std::stable_sort(expectedValues.begin(), expectedValues.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+            std::vector<uint32_t> expectedKeys(count);
+            for (uint32_t i = 0; i < count; i++) {
+                expectedKeys[i] = keys[expectedValues[i]];
+            }
+            bool sorted = download(inputBuffer, count) == expectedKeys && download(outputBuffer, count) == expectedValues;
+            passed = report("sortPairs", count, sorted) && passed;
+
+            // stream compaction：保留大约一半的元素
+            std::vector<uint32_t> flags = randomData(count, 1);
+            DeviceBuffer flagBuffer = createDeviceBuffer(count);
+            DeviceBuffer countBuffer = createDeviceBuffer(1);
+            upload(inputBuffer, input);
+            upload(flagBuffer, flags);
+            submitAndWait([&](VkCommandBuffer commandBuffer) {
+                primitives.compact(commandBuffer, inputBuffer.buffer, flagBuffer.buffer, count, outputBuffer.buffer, countBuffer.buffer);
+            });
+            primitives.reset();
+            std::vector<uint32_t> expectedCompact;
+            for (uint32_t i = 0; i < count; i++) {
+                if (flags[i] != 0) {
+                    expectedCompact.push_back(input[i]);
+                }
+            }
+            uint32_t compactCount = download(countBuffer, 1)[0];
+            bool compacted = compactCount == expectedCompact.size() &&
+                             (compactCount == 0 || download(outputBuffer, compactCount) == expectedCompact);
+            passed = report("compact", count, compacted) && passed;
+
+            destroyDeviceBuffer(countBuffer);
+            destroyDeviceBuffer(flagBuffer);
+            destroyDeviceBuffer(outputBuffer);
+            destroyDeviceBuffer(inputBuffer);
+        }
+
+        return passed;
+    }
+
+    // 连续执行benchmarkIterations次，按墙上时间计算吞吐量
+    // 每次调度占用一个描述集，一个命令缓冲中录制的迭代次数受描述池大小限制，超出时分批提交
+    void measure(GpuPrimitives& primitives, const std::string& name, const std::function<void(VkCommandBuffer)>& record) {
+        // 预热一次，创建临时缓冲，同时得到一次迭代使用的描述集数量
+        submitAndWait(record);
+        uint32_t setsPerIteration = std::max(primitives.getAllocatedSetCount(), 1u);
+        primitives.reset();
+        if (setsPerIteration > MAX_DESCRIPTOR_SETS) {
+            throw std::runtime_error(name + " needs " + std::to_string(setsPerIteration) + " descriptor sets per iteration, more than MAX_DESCRIPTOR_SETS!");
+        }
+        uint32_t iterationsPerBatch = MAX_DESCRIPTOR_SETS / setsPerIteration;
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (uint32_t done = 0; done < benchmarkIterations; done += iterationsPerBatch) {
+            uint32_t batch = std::min(iterationsPerBatch, benchmarkIterations - done);
+            submitAndWait([&](VkCommandBuffer commandBuffer) {
+                for (uint32_t i = 0; i < batch; i++) {
+                    record(commandBuffer);
+                }
+            });
+            primitives.reset();
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(endTime - startTime).count() / benchmarkIterations;
+        std::cout << "  " << std::left << std::setw(12) << name << std::fixed << std::setprecision(3)
+                  << ms << " ms, " << std::setprecision(1) << benchmarkCount / ms / 1000.0 << " M elements/s" << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    void runBenchmarks(GpuPrimitives& primitives) {
+        uint32_t count = benchmarkCount;
+        std::cout << "  benchmark: " << count << " elements, " << benchmarkIterations << " iterations" << std::endl;
+
+        DeviceBuffer inputBuffer = createDeviceBuffer(count);
+        DeviceBuffer outputBuffer = createDeviceBuffer(count);
+        DeviceBuffer keyBuffer = createDeviceBuffer(count);
+        DeviceBuffer flagBuffer = createDeviceBuffer(count);
+        DeviceBuffer countBuffer = createDeviceBuffer(1);
+        upload(inputBuffer, randomData(count, 1000));
+        upload(keyBuffer, randomData(count, std::numeric_limits<uint32_t>::max()));
+        upload(flagBuffer, randomData(count, 1));
+
+        measure(primitives, "reduce", [&](VkCommandBuffer commandBuffer) {
+            primitives.reduce(commandBuffer, inputBuffer.buffer, count, countBuffer.buffer);
+        });
+        measure(primitives, "scan", [&](VkCommandBuffer commandBuffer) {
+            primitives.exclusiveScan(commandBuffer, inputBuffer.buffer, outputBuffer.buffer, count);
+        });
+        // 每次迭代对已排序的数据再排序，耗时与随机数据相同(每趟都处理所有元素)
+        measure(primitives, "sortPairs", [&](VkCommandBuffer commandBuffer) {
+            primitives.sortPairs(commandBuffer, keyBuffer.buffer, outputBuffer.buffer, count);
+        });
+        measure(primitives, "compact", [&](VkCommandBuffer commandBuffer) {
+            primitives.compact(commandBuffer, inputBuffer.buffer, flagBuffer.buffer, count, outputBuffer.buffer, countBuffer.buffer);
+        });
+
+        destroyDeviceBuffer(countBuffer);
+        destroyDeviceBuffer(flagBuffer);
+        destroyDeviceBuffer(keyBuffer);
+        destroyDeviceBuffer(outputBuffer);
+        destroyDeviceBuffer(inputBuffer);
+    }
+
+    bool checkValidationLayerSupport() {
+        uint32_t layerCount;
+        vkEnumerateInstanceLayerProperties(&layerCount, nullptr);
+
+        std::vector<VkLayerProperties> availableLayers(layerCount);
+        vkEnumerateInstanceLayerProperties(&layerCount, availableLayers.data());
+
+        for (const char* layerName : validationLayers) {
+            bool layerFound = false;
+
+            for (const auto& layerProperties : availableLayers) {
+                if (strcmp(layerName, layerProperties.layerName) == 0) {
+                    layerFound = true;
+                    break;
+                }
+            }
+
+            if (!layerFound) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity, VkDebugUtilsMessageTypeFlagsEXT messageType, const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData, void* pUserData) {
+        std::cerr << "validation layer: " << pCallbackData->pMessage << std::endl;
+
+        return VK_FALSE;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    PrimitivesApplication app;
+
+    try {
+        app.parseArguments(argc, argv);
+        if (!app.run()) {
+            return EXIT_FAILURE;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
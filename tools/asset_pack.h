@@ -0,0 +1,73 @@
+/*
+    * 资源包格式 Asset Pack Format
+    * asset_packer在构建时生成，章节在运行时映射到内存后直接读取，两边共用这里的定义。
+    *
+    * 文件布局(小端)：
+    *   PackHeader
+    *   PackEntry[entryCount]        索引表，按名字查找
+    *   数据块                        每块按ALIGNMENT对齐
+    * 数据块的内容按类型区分：
+    *   Shader   SPIR-V字节码
+    *   Mesh     MeshHeader + PackedVertex[vertexCount] + uint32_t[indexCount]
+    *   Texture  TextureHeader + RGBA8像素
+*/
+#pragma once
+
+#include <cstdint>
+
+namespace assetpack {
+
+const uint32_t MAGIC = 0x4b504156; // "VAPK"
+const uint32_t VERSION = 1;
+// 映射的起始地址按页对齐，数据块按16字节对齐后可以直接按uint32_t/float读取
+const uint64_t ALIGNMENT = 16;
+const uint32_t MAX_NAME_LENGTH = 64;
+
+enum class AssetType : uint32_t {
+    Shader = 1,
+    Mesh = 2,
+    Texture = 3,
+};
+
+struct PackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+struct PackEntry {
+    char name[MAX_NAME_LENGTH];// 以'\0'结尾的文件名，不含目录
+    AssetType type;
+    uint32_t reserved;
+    uint64_t offset;// 相对文件开头
+    uint64_t size;
+};
+
+struct MeshHeader {
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t vertexStride;
+    uint32_t reserved;
+};
+
+// 与章节中的Vertex布局一致: pos, color, texCoord
+struct PackedVertex {
+    float pos[3];
+    float color[3];
+    float texCoord[2];
+};
+
+struct TextureHeader {
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;// 固定为4 (RGBA8)
+    uint32_t reserved;
+};
+
+static_assert(sizeof(PackHeader) % ALIGNMENT == 0, "PackHeader must keep the entry table aligned");
+static_assert(sizeof(PackEntry) % sizeof(uint64_t) == 0, "PackEntry must keep the offsets in the entry table aligned");
+static_assert(sizeof(MeshHeader) % ALIGNMENT == 0, "MeshHeader must keep the vertices aligned");
+static_assert(sizeof(TextureHeader) % ALIGNMENT == 0, "TextureHeader must keep the pixels aligned");
+
+}
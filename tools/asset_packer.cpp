@@ -0,0 +1,245 @@
+/*
+    * 资源打包工具 Asset Packer
+    * 在构建时把着色器、模型和纹理打包成一个资源包(格式见asset_pack.h)，由CMake中的PACK_SHADER/PACK_ASSETS调用。
+    * 模型和纹理在这里就处理成GPU可以直接使用的数据：
+    *   .obj        用tinyobjloader读取并去重，写入顶点和索引
+    *   .png/.jpg   用stb_image解码为RGBA8
+    *   .spv        原样写入
+    * 资源按文件名查找，名字不能重复。先写入临时文件，成功后再替换输出，失败时不会留下不完整的资源包。
+    * 运行时只需要把数据块从映射的内存复制到暂存缓冲区，不再解析文件。
+    *
+    * 用法: asset_packer <output.pack> <input>...
+*/
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <tiny_obj_loader.h>
+
+#include "asset_pack.h"
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+#include <array>
+#include <filesystem>
+#include <cstring>
+#include <cstdint>
+
+struct Asset {
+    std::string name;
+    assetpack::AssetType type;
+    std::vector<uint8_t> data;
+};
+
+static std::string getFileName(const std::string& path) {
+    size_t separator = path.find_last_of("/\\");
+    return separator == std::string::npos ? path : path.substr(separator + 1);
+}
+
+static std::string getExtension(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    return dot == std::string::npos ? "" : path.substr(dot);
+}
+
+static void appendBytes(std::vector<uint8_t>& data, const void* bytes, size_t size) {
+    const uint8_t* begin = static_cast<const uint8_t*>(bytes);
+    data.insert(data.end(), begin, begin + size);
+}
+
+static std::vector<uint8_t> readFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::ate | std::ios::binary);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("failed to open " + filename + "!");
+    }
+
+    size_t fileSize = (size_t) file.tellg();
+    std::vector<uint8_t> buffer(fileSize);
+
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(buffer.data()), fileSize);
+
+    return buffer;
+}
+
+static std::vector<uint8_t> packShader(const std::string& path) {
+    std::vector<uint8_t> code = readFile(path);
+    if (code.size() % sizeof(uint32_t) != 0) {
+        throw std::runtime_error(path + " is not a valid SPIR-V binary!");
+    }
+    return code;
+}
+
+// 与章节中loadModel相同的去重方式，顶点按内容比较
+static std::vector<uint8_t> packMesh(const std::string& path) {
+    tinyobj::attrib_t attrib;
+    std::vector<tinyobj::shape_t> shapes;
+    std::vector<tinyobj::material_t> materials;
+    std::string warn, err;
+
+    if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, path.c_str())) {
+        throw std::runtime_error(warn + err);
+    }
+
+    std::vector<assetpack::PackedVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::map<std::array<float, 8>, uint32_t> uniqueVertices;
+
+    for (const auto& shape : shapes) {
+        for (const auto& index : shape.mesh.indices) {
+            std::array<float, 8> key = {
+                attrib.vertices[3 * index.vertex_index + 0],
+                attrib.vertices[3 * index.vertex_index + 1],
+                attrib.vertices[3 * index.vertex_index + 2],
+                1.0f, 1.0f, 1.0f,
+                attrib.texcoords[2 * index.texcoord_index + 0],
+                1.0f - attrib.texcoords[2 * index.texcoord_index + 1]
+            };
+
+            auto it = uniqueVertices.find(key);
+            if (it == uniqueVertices.end()) {
+                assetpack::PackedVertex vertex{};
+                memcpy(&vertex, key.data(), sizeof(vertex));
+                it = uniqueVertices.emplace(key, static_cast<uint32_t>(vertices.size())).first;
+                vertices.push_back(vertex);
+            }
+            indices.push_back(it->second);
+        }
+    }
+
+    assetpack::MeshHeader header{};
+    header.vertexCount = static_cast<uint32_t>(vertices.size());
+    header.indexCount = static_cast<uint32_t>(indices.size());
+    header.vertexStride = sizeof(assetpack::PackedVertex);
+
+    std::vector<uint8_t> data;
+    appendBytes(data, &header, sizeof(header));
+    appendBytes(data, vertices.data(), vertices.size() * sizeof(vertices[0]));
+    appendBytes(data, indices.data(), indices.size() * sizeof(indices[0]));
+    return data;
+}
+
+static std::vector<uint8_t> packTexture(const std::string& path) {
+    int texWidth, texHeight, texChannels;
+    stbi_uc* pixels = stbi_load(path.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+    if (!pixels) {
+        throw std::runtime_error("failed to load texture image " + path + "!");
+    }
+
+    assetpack::TextureHeader header{};
+    header.width = static_cast<uint32_t>(texWidth);
+    header.height = static_cast<uint32_t>(texHeight);
+    header.channels = 4;
+
+    std::vector<uint8_t> data;
+    appendBytes(data, &header, sizeof(header));
+    appendBytes(data, pixels, static_cast<size_t>(texWidth) * texHeight * 4);
+    stbi_image_free(pixels);
+    return data;
+}
+
+static Asset packAsset(const std::string& path) {
+    Asset asset{};
+    asset.name = getFileName(path);
+    if (asset.name.size() >= assetpack::MAX_NAME_LENGTH) {
+        throw std::runtime_error("asset name " + asset.name + " is too long!");
+    }
+
+    std::string extension = getExtension(path);
+    if (extension == ".spv") {
+        asset.type = assetpack::AssetType::Shader;
+        asset.data = packShader(path);
+    } else if (extension == ".obj") {
+        asset.type = assetpack::AssetType::Mesh;
+        asset.data = packMesh(path);
+    } else if (extension == ".png" || extension == ".jpg") {
+        asset.type = assetpack::AssetType::Texture;
+        asset.data = packTexture(path);
+    } else {
+        throw std::runtime_error("unsupported asset type " + path + "!");
+    }
+    return asset;
+}
+
+static uint64_t alignUp(uint64_t value) {
+    return (value + assetpack::ALIGNMENT - 1) & ~(assetpack::ALIGNMENT - 1);
+}
+
+static void writePack(const std::string& filename, const std::vector<Asset>& assets) {
+    assetpack::PackHeader header{};
+    header.magic = assetpack::MAGIC;
+    header.version = assetpack::VERSION;
+    header.entryCount = static_cast<uint32_t>(assets.size());
+
+    // 先确定每个数据块的位置，再依次写入
+    std::vector<assetpack::PackEntry> entries(assets.size());
+    std::set<std::string> names;
+    uint64_t offset = sizeof(header) + sizeof(assetpack::PackEntry) * assets.size();
+    for (size_t i = 0; i < assets.size(); i++) {
+        if (!names.insert(assets[i].name).second) {
+            throw std::runtime_error("duplicate asset name " + assets[i].name + "!");
+        }
+        // 长度已在packAsset中检查过，条目是零初始化的，名字总以'\0'结尾
+        memcpy(entries[i].name, assets[i].name.c_str(), assets[i].name.size());
+        entries[i].type = assets[i].type;
+        entries[i].offset = alignUp(offset);
+        entries[i].size = assets[i].data.size();
+        offset = entries[i].offset + entries[i].size;
+    }
+
+    std::string tempFilename = filename + ".tmp";
+    std::ofstream file(tempFilename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("failed to open " + tempFilename + "!");
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()), sizeof(entries[0]) * entries.size());
+
+    const char padding[assetpack::ALIGNMENT] = {};
+    uint64_t position = sizeof(header) + sizeof(assetpack::PackEntry) * assets.size();
+    for (size_t i = 0; i < assets.size(); i++) {
+        file.write(padding, entries[i].offset - position);
+        file.write(reinterpret_cast<const char*>(assets[i].data.data()), assets[i].data.size());
+        position = entries[i].offset + entries[i].size;
+    }
+
+    file.close();
+    std::error_code error;
+    if (!file) {
+        std::filesystem::remove(tempFilename, error);
+        throw std::runtime_error("failed to write " + tempFilename + "!");
+    }
+
+    std::filesystem::rename(tempFilename, filename, error);
+    if (error) {
+        std::filesystem::remove(tempFilename, error);
+        throw std::runtime_error("failed to rename " + tempFilename + " to " + filename + "!");
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: asset_packer <output.pack> <input>..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        std::vector<Asset> assets;
+        for (int i = 2; i < argc; i++) {
+            assets.push_back(packAsset(argv[i]));
+        }
+        writePack(argv[1], assets);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}